@@ -0,0 +1,616 @@
+/*
+ * Benchmark de regresión de la build nativa.
+ *
+ * Incluye hello_esp32.c tal cual para ejercitar los handlers reales y el
+ * enrutado de start_webserver() sobre loopback. Mide req/s y latencia por
+ * endpoint, el coste de get_system_info_json() y el uso máximo de memoria,
+ * escribe los resultados en JSON y los compara contra una baseline.
+ *
+ * /api/restart no se mide: llama a esp_restart(), que termina el proceso.
+ */
+#define _GNU_SOURCE
+#include "hello_esp32.c"
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/utsname.h>
+#include "esp_host.h"
+
+#define BENCH_MAX_METRICS     64
+#define BENCH_RESP_BUF_LEN    (64 * 1024)
+#define BENCH_MAX_NAME_LEN    64
+#define BENCH_MAX_REPEATS     15
+#define BENCH_ENV_LEN         128
+
+/* Tolerancia por métrica: las de tiempo usan la de -t, las informativas no se comparan */
+#define BENCH_TOL_TIMING      0.0
+#define BENCH_TOL_INFO        -1.0
+
+static const char *BENCH_TAG = "bench";
+
+typedef struct {
+    const char *name;
+    const char *method;
+    const char *uri;
+    const char *(*body)(int iteration);
+} bench_endpoint_t;
+
+typedef struct {
+    char name[BENCH_MAX_NAME_LEN];
+    double value;
+    double runs[BENCH_MAX_REPEATS];
+    int run_count;
+} bench_metric_t;
+
+typedef struct {
+    bench_metric_t items[BENCH_MAX_METRICS];
+    int count;
+} bench_metrics_t;
+
+typedef struct {
+    const char *suffix;
+    double tolerance;
+} bench_rule_t;
+
+typedef struct {
+    char build_type[BENCH_ENV_LEN];
+    char compiler[BENCH_ENV_LEN];
+    char system[BENCH_ENV_LEN];
+    char cpu[BENCH_ENV_LEN];
+} bench_env_t;
+
+typedef struct {
+    int requests;
+    int warmup;
+    int json_cycles;
+    int repeats;
+    double tolerance;
+    const char *output;
+    const char *baseline;
+} bench_config_t;
+
+/* El buffer de respuesta es estático para no contaminar la medida del heap */
+static char s_resp_buf[BENCH_RESP_BUF_LEN];
+
+static const char *led_body(int iteration)
+{
+    return (iteration & 1) ? "{\"state\":true}" : "{\"state\":false}";
+}
+
+static const bench_endpoint_t s_endpoints[] = {
+    { "get_root", "GET",  "/",         NULL },
+    { "get_data", "GET",  "/api/data", NULL },
+    { "post_led", "POST", "/api/led",  led_body },
+};
+
+/*
+ * Solo se usan como puerta las métricas estables: throughput, mediana de
+ * latencia, coste del JSON y tamaños/memoria controlados por el shim. Los
+ * percentiles altos, la media (arrastrada por los picos) y el RSS (depende
+ * de libc y cargador) se escriben pero no se comparan. Gana la primera regla
+ * cuyo sufijo coincida; sin regla, la métrica es informativa.
+ */
+static const bench_rule_t s_rules[] = {
+    { "shim_heap_query.ns_per_op", BENCH_TOL_INFO },
+    { ".req_per_s",                BENCH_TOL_TIMING },
+    { ".lat_p50_us",               BENCH_TOL_TIMING },
+    { ".ops_per_s",                BENCH_TOL_INFO },   /* inverso de ns_per_op */
+    { ".ns_per_op",                BENCH_TOL_TIMING },
+    { "bytes",                     10.0 },
+};
+
+static int64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/* Más alto es mejor para los throughputs; para el resto (latencias, memoria) más bajo es mejor */
+static bool higher_is_better(const char *name)
+{
+    size_t len = strlen(name);
+    return len > 6 && strcmp(name + len - 6, "_per_s") == 0;
+}
+
+static bench_metric_t *metric_find(bench_metrics_t *m, const char *name)
+{
+    for (int i = 0; i < m->count; i++) {
+        if (strcmp(m->items[i].name, name) == 0) {
+            return &m->items[i];
+        }
+    }
+    return NULL;
+}
+
+static double metric_tolerance(const bench_config_t *cfg, const char *name)
+{
+    size_t len = strlen(name);
+
+    for (size_t i = 0; i < sizeof(s_rules) / sizeof(s_rules[0]); i++) {
+        size_t suffix_len = strlen(s_rules[i].suffix);
+        if (len >= suffix_len && strcmp(name + len - suffix_len, s_rules[i].suffix) == 0) {
+            return s_rules[i].tolerance == BENCH_TOL_TIMING ? cfg->tolerance : s_rules[i].tolerance;
+        }
+    }
+    return BENCH_TOL_INFO;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Guarda el valor de una repetición; metrics_finalize() se queda con la mediana */
+static void metric_record(bench_metrics_t *m, const char *prefix, const char *suffix, double value)
+{
+    char name[BENCH_MAX_NAME_LEN];
+    snprintf(name, sizeof(name), "%s.%s", prefix, suffix);
+
+    bench_metric_t *metric = metric_find(m, name);
+    if (metric == NULL) {
+        if (m->count == BENCH_MAX_METRICS) {
+            ESP_LOGE(BENCH_TAG, "Demasiadas métricas, descartando %s", name);
+            return;
+        }
+        metric = &m->items[m->count++];
+        snprintf(metric->name, sizeof(metric->name), "%s", name);
+    }
+    if (metric->run_count < BENCH_MAX_REPEATS) {
+        metric->runs[metric->run_count++] = value;
+    }
+}
+
+static void metrics_finalize(bench_metrics_t *m)
+{
+    for (int i = 0; i < m->count; i++) {
+        bench_metric_t *metric = &m->items[i];
+        double sorted[BENCH_MAX_REPEATS];
+        int n = metric->run_count;
+
+        memcpy(sorted, metric->runs, (size_t)n * sizeof(sorted[0]));
+        qsort(sorted, (size_t)n, sizeof(sorted[0]), cmp_double);
+        metric->value = (n % 2) ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0;
+    }
+}
+
+static void env_collect(bench_env_t *env)
+{
+    struct utsname uts;
+
+    snprintf(env->build_type, sizeof(env->build_type), "%s", BENCH_BUILD_TYPE);
+    snprintf(env->compiler, sizeof(env->compiler), "%s", BENCH_COMPILER);
+    snprintf(env->system, sizeof(env->system), "desconocido");
+    snprintf(env->cpu, sizeof(env->cpu), "desconocida");
+    if (uname(&uts) == 0) {
+        snprintf(env->system, sizeof(env->system), "%.40s %.40s %.40s", uts.sysname, uts.release, uts.machine);
+    }
+
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    if (f != NULL) {
+        char line[256];
+        while (fgets(line, sizeof(line), f) != NULL) {
+            if (sscanf(line, "model name : %127[^\n]", env->cpu) == 1) {
+                break;
+            }
+        }
+        fclose(f);
+    }
+}
+
+static int client_connect(uint16_t port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(port),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/* Envía una petición keep-alive y lee la respuesta completa. Devuelve el tamaño del cuerpo o -1 */
+static int client_request(int fd, const bench_endpoint_t *ep, int iteration)
+{
+    char req[512];
+    const char *body = ep->body ? ep->body(iteration) : "";
+    int len = snprintf(req, sizeof(req),
+                       "%s %s HTTP/1.1\r\n"
+                       "Host: localhost\r\n"
+                       "Content-Type: application/json\r\n"
+                       "Content-Length: %zu\r\n"
+                       "\r\n"
+                       "%s",
+                       ep->method, ep->uri, strlen(body), body);
+    if (send(fd, req, (size_t)len, MSG_NOSIGNAL) != len) {
+        return -1;
+    }
+
+    size_t got = 0;
+    char *hdr_end = NULL;
+    while (hdr_end == NULL) {
+        ssize_t n = recv(fd, s_resp_buf + got, sizeof(s_resp_buf) - 1 - got, 0);
+        if (n <= 0) {
+            return -1;
+        }
+        got += (size_t)n;
+        s_resp_buf[got] = '\0';
+        hdr_end = strstr(s_resp_buf, "\r\n\r\n");
+    }
+
+    if (strncmp(s_resp_buf, "HTTP/1.1 200", 12) != 0) {
+        ESP_LOGE(BENCH_TAG, "%s %s respondió: %.*s", ep->method, ep->uri,
+                 (int)strcspn(s_resp_buf, "\r"), s_resp_buf);
+        return -1;
+    }
+    const char *cl = strcasestr(s_resp_buf, "Content-Length:");
+    if (cl == NULL || cl > hdr_end) {
+        return -1;
+    }
+    size_t body_len = strtoul(cl + 15, NULL, 10);
+    size_t total = (size_t)(hdr_end - s_resp_buf) + 4 + body_len;
+    if (total >= sizeof(s_resp_buf)) {
+        return -1;
+    }
+    while (got < total) {
+        ssize_t n = recv(fd, s_resp_buf + got, total - got, 0);
+        if (n <= 0) {
+            return -1;
+        }
+        got += (size_t)n;
+    }
+    return (int)body_len;
+}
+
+static int cmp_int64(const void *a, const void *b)
+{
+    int64_t x = *(const int64_t *)a;
+    int64_t y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile_us(const int64_t *sorted, int count, double pct)
+{
+    int idx = (int)(pct / 100.0 * (count - 1) + 0.5);
+    return sorted[idx] / 1000.0;
+}
+
+static esp_err_t bench_endpoint(const bench_config_t *cfg, uint16_t port,
+                                const bench_endpoint_t *ep, int64_t *samples,
+                                bench_metrics_t *metrics)
+{
+    int fd = client_connect(port);
+    if (fd < 0) {
+        ESP_LOGE(BENCH_TAG, "No se pudo conectar al puerto %u: %s", port, strerror(errno));
+        return ESP_FAIL;
+    }
+
+    int body_len = 0;
+    for (int i = 0; i < cfg->warmup; i++) {
+        if (client_request(fd, ep, i) < 0) {
+            close(fd);
+            return ESP_FAIL;
+        }
+    }
+
+    int64_t start = now_ns();
+    for (int i = 0; i < cfg->requests; i++) {
+        int64_t t0 = now_ns();
+        body_len = client_request(fd, ep, i);
+        samples[i] = now_ns() - t0;
+        if (body_len < 0) {
+            ESP_LOGE(BENCH_TAG, "%s: petición %d fallida", ep->name, i);
+            close(fd);
+            return ESP_FAIL;
+        }
+    }
+    int64_t elapsed = now_ns() - start;
+    close(fd);
+
+    qsort(samples, (size_t)cfg->requests, sizeof(samples[0]), cmp_int64);
+    double total_ns = 0;
+    for (int i = 0; i < cfg->requests; i++) {
+        total_ns += (double)samples[i];
+    }
+
+    metric_record(metrics, ep->name, "req_per_s", cfg->requests / (elapsed / 1e9));
+    metric_record(metrics, ep->name, "lat_mean_us", total_ns / cfg->requests / 1000.0);
+    metric_record(metrics, ep->name, "lat_p50_us", percentile_us(samples, cfg->requests, 50));
+    metric_record(metrics, ep->name, "lat_p90_us", percentile_us(samples, cfg->requests, 90));
+    metric_record(metrics, ep->name, "lat_p99_us", percentile_us(samples, cfg->requests, 99));
+    metric_record(metrics, ep->name, "resp_bytes", body_len);
+    return ESP_OK;
+}
+
+static void bench_json_build(const bench_config_t *cfg, bench_metrics_t *metrics)
+{
+    char json_buffer[1024];
+    size_t len = 0;
+
+    int64_t start = now_ns();
+    for (int i = 0; i < cfg->json_cycles; i++) {
+        get_system_info_json(json_buffer, sizeof(json_buffer));
+        len = strlen(json_buffer);
+    }
+    int64_t elapsed = now_ns() - start;
+
+    metric_record(metrics, "json_build", "ops_per_s", cfg->json_cycles / (elapsed / 1e9));
+    metric_record(metrics, "json_build", "ns_per_op", (double)elapsed / cfg->json_cycles);
+    metric_record(metrics, "json_build", "bytes", (double)len);
+
+    /* Coste del shim dentro de json_build: consultas de heap que hace get_system_info_json() */
+    volatile uint32_t sink = 0;
+    start = now_ns();
+    for (int i = 0; i < cfg->json_cycles; i++) {
+        sink += esp_get_free_heap_size();
+        sink += esp_get_minimum_free_heap_size();
+    }
+    elapsed = now_ns() - start;
+    (void)sink;
+    metric_record(metrics, "shim_heap_query", "ns_per_op", (double)elapsed / cfg->json_cycles);
+}
+
+static esp_err_t write_results(const bench_config_t *cfg, const bench_env_t *env,
+                               const bench_metrics_t *metrics)
+{
+    FILE *f = fopen(cfg->output, "w");
+    if (f == NULL) {
+        ESP_LOGE(BENCH_TAG, "No se pudo escribir %s: %s", cfg->output, strerror(errno));
+        return ESP_FAIL;
+    }
+
+    fprintf(f, "{\n"
+               "  \"suite\": \"hello_esp32_host\",\n"
+               "  \"config\": {\n"
+               "    \"requests\": %d,\n"
+               "    \"warmup\": %d,\n"
+               "    \"json_cycles\": %d,\n"
+               "    \"repeats\": %d\n"
+               "  },\n"
+               "  \"environment\": {\n"
+               "    \"build_type\": \"%s\",\n"
+               "    \"compiler\": \"%s\",\n"
+               "    \"system\": \"%s\",\n"
+               "    \"cpu\": \"%s\"\n"
+               "  },\n"
+               "  \"metrics\": {\n",
+            cfg->requests, cfg->warmup, cfg->json_cycles, cfg->repeats,
+            env->build_type, env->compiler, env->system, env->cpu);
+    for (int i = 0; i < metrics->count; i++) {
+        fprintf(f, "    \"%s\": %.3f%s\n", metrics->items[i].name, metrics->items[i].value,
+                i + 1 < metrics->count ? "," : "");
+    }
+    fprintf(f, "  }\n}\n");
+    fclose(f);
+    return ESP_OK;
+}
+
+/* Lee el entorno y el bloque "metrics" de un fichero generado por write_results() */
+static esp_err_t read_baseline(const char *path, bench_env_t *env, bench_metrics_t *baseline)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    char line[256];
+    bool in_metrics = false;
+    baseline->count = 0;
+    while (fgets(line, sizeof(line), f) != NULL && baseline->count < BENCH_MAX_METRICS) {
+        if (!in_metrics) {
+            char value[BENCH_ENV_LEN];
+            if (sscanf(line, " \"build_type\": \"%127[^\"]\"", value) == 1) {
+                snprintf(env->build_type, sizeof(env->build_type), "%s", value);
+            } else if (sscanf(line, " \"compiler\": \"%127[^\"]\"", value) == 1) {
+                snprintf(env->compiler, sizeof(env->compiler), "%s", value);
+            } else if (sscanf(line, " \"system\": \"%127[^\"]\"", value) == 1) {
+                snprintf(env->system, sizeof(env->system), "%s", value);
+            } else if (sscanf(line, " \"cpu\": \"%127[^\"]\"", value) == 1) {
+                snprintf(env->cpu, sizeof(env->cpu), "%s", value);
+            }
+            in_metrics = strstr(line, "\"metrics\"") != NULL;
+            continue;
+        }
+        bench_metric_t *m = &baseline->items[baseline->count];
+        if (sscanf(line, " \"%63[^\"]\": %lf", m->name, &m->value) == 2) {
+            baseline->count++;
+        }
+    }
+    fclose(f);
+    return baseline->count > 0 ? ESP_OK : ESP_FAIL;
+}
+
+static int compare_baseline(const bench_config_t *cfg, const bench_env_t *env,
+                            bench_metrics_t *metrics)
+{
+    bench_metrics_t baseline;
+    bench_env_t base_env = { 0 };
+    esp_err_t err = read_baseline(cfg->baseline, &base_env, &baseline);
+    if (err == ESP_ERR_NOT_FOUND) {
+        ESP_LOGE(BENCH_TAG, "No existe la baseline %s; usa -B para no comparar", cfg->baseline);
+        return 2;
+    } else if (err != ESP_OK) {
+        ESP_LOGE(BENCH_TAG, "Baseline %s sin métricas", cfg->baseline);
+        return 2;
+    }
+
+    if (strcmp(base_env.build_type, env->build_type) != 0 ||
+        strcmp(base_env.compiler, env->compiler) != 0 ||
+        strcmp(base_env.system, env->system) != 0 ||
+        strcmp(base_env.cpu, env->cpu) != 0) {
+        printf("\nAVISO: la baseline se generó en otro entorno; los tiempos no son comparables.\n"
+               "  baseline: %s | %s | %s | %s\n"
+               "  actual:   %s | %s | %s | %s\n",
+               base_env.build_type, base_env.compiler, base_env.system, base_env.cpu,
+               env->build_type, env->compiler, env->system, env->cpu);
+    }
+
+    int regressions = 0;
+    printf("\n%-28s %14s %14s %9s %6s\n", "métrica", "baseline", "actual", "delta", "tol");
+    for (int i = 0; i < baseline.count; i++) {
+        const bench_metric_t *base = &baseline.items[i];
+        const bench_metric_t *cur = metric_find(metrics, base->name);
+        if (cur == NULL) {
+            printf("%-28s %14.3f %14s %9s  FALTA\n", base->name, base->value, "-", "-");
+            regressions++;
+            continue;
+        }
+
+        double tolerance = metric_tolerance(cfg, base->name);
+        if (tolerance == BENCH_TOL_INFO) {
+            printf("%-28s %14.3f %14.3f %9s %6s\n", base->name, base->value, cur->value, "", "info");
+            continue;
+        }
+
+        /* Con baseline 0 no hay porcentaje: cualquier valor peor que 0 es regresión */
+        if (base->value == 0) {
+            bool regressed = higher_is_better(base->name) ? false : cur->value > 0;
+            regressions += regressed;
+            printf("%-28s %14.3f %14.3f %9s %5.0f%%%s\n", base->name, base->value, cur->value,
+                   "n/a", tolerance, regressed ? "  REGRESIÓN" : "");
+            continue;
+        }
+
+        double delta = (cur->value - base->value) / base->value * 100.0;
+        double worse = higher_is_better(base->name) ? -delta : delta;
+        bool regressed = worse > tolerance;
+        regressions += regressed;
+        printf("%-28s %14.3f %14.3f %+8.1f%% %5.0f%%%s\n", base->name, base->value, cur->value,
+               delta, tolerance, regressed ? "  REGRESIÓN" : "");
+    }
+
+    if (regressions) {
+        printf("\n%d métrica(s) empeoran más de su tolerancia respecto a %s\n",
+               regressions, cfg->baseline);
+        return 1;
+    }
+    printf("\nSin regresiones (tolerancia de tiempos %.0f%%)\n", cfg->tolerance);
+    return 0;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "Uso: %s [-n peticiones] [-w calentamiento] [-j ciclos_json] [-r repeticiones]\n"
+            "          [-t tolerancia_%%] [-o resultados.json] [-b baseline.json | -B]\n"
+            "  -r  repeticiones (máx. %d); cada métrica se reporta como la mediana\n"
+            "  -t  tolerancia de las métricas de tiempo (req/s, p50, json_build)\n"
+            "  -B  no compara contra ninguna baseline\n",
+            prog, BENCH_MAX_REPEATS);
+}
+
+int main(int argc, char **argv)
+{
+    bench_config_t cfg = {
+        .requests = 5000,
+        .warmup = 500,
+        .json_cycles = 200000,
+        .repeats = 5,
+        .tolerance = 25.0,
+        .output = "bench_results.json",
+        .baseline = BENCH_DEFAULT_BASELINE,
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:w:j:r:t:o:b:Bh")) != -1) {
+        switch (opt) {
+        case 'n': cfg.requests = atoi(optarg); break;
+        case 'w': cfg.warmup = atoi(optarg); break;
+        case 'j': cfg.json_cycles = atoi(optarg); break;
+        case 'r': cfg.repeats = atoi(optarg); break;
+        case 't': cfg.tolerance = atof(optarg); break;
+        case 'o': cfg.output = optarg; break;
+        case 'b': cfg.baseline = optarg; break;
+        case 'B': cfg.baseline = NULL; break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (cfg.requests <= 0 || cfg.warmup < 0 || cfg.json_cycles <= 0 ||
+        cfg.repeats <= 0 || cfg.repeats > BENCH_MAX_REPEATS) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    /* Las muestras van fuera del heap emulado para no falsear esp_get_free_heap_size() */
+    size_t samples_size = (size_t)cfg.requests * sizeof(int64_t);
+    int64_t *samples = mmap(NULL, samples_size, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (samples == MAP_FAILED) {
+        ESP_LOGE(BENCH_TAG, "Sin memoria para %d muestras", cfg.requests);
+        return 2;
+    }
+
+    esp_log_level_set("*", ESP_LOG_WARN);
+    setenv(ESP_HOST_HTTPD_PORT_ENV, "0", 0);
+
+    led_init();
+    wifi_init_sta();
+    uint32_t free_heap_before = esp_get_free_heap_size();
+    httpd_handle_t server = start_webserver();
+    if (server == NULL) {
+        ESP_LOGE(BENCH_TAG, "No se pudo iniciar el servidor");
+        return 2;
+    }
+    uint16_t port = esp_host_httpd_port(server);
+
+    static bench_metrics_t metrics;
+    for (int r = 0; r < cfg.repeats; r++) {
+        for (size_t i = 0; i < sizeof(s_endpoints) / sizeof(s_endpoints[0]); i++) {
+            if (bench_endpoint(&cfg, port, &s_endpoints[i], samples, &metrics) != ESP_OK) {
+                httpd_stop(server);
+                return 2;
+            }
+        }
+        bench_json_build(&cfg, &metrics);
+    }
+
+    uint32_t min_free_heap = esp_get_minimum_free_heap_size();
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    metric_record(&metrics, "memory", "heap_high_water_bytes",
+                  free_heap_before > min_free_heap ? free_heap_before - min_free_heap : 0);
+    metric_record(&metrics, "memory", "httpd_stack_peak_bytes",
+                  (double)esp_host_httpd_stack_peak(server));
+    metric_record(&metrics, "memory", "peak_rss_kb", (double)usage.ru_maxrss);
+
+    httpd_stop(server);
+    munmap(samples, samples_size);
+    metrics_finalize(&metrics);
+
+    bench_env_t env;
+    env_collect(&env);
+
+    printf("%-28s %14s\n", "métrica", "valor");
+    for (int i = 0; i < metrics.count; i++) {
+        printf("%-28s %14.3f\n", metrics.items[i].name, metrics.items[i].value);
+    }
+
+    if (write_results(&cfg, &env, &metrics) != ESP_OK) {
+        return 2;
+    }
+    printf("\nResultados escritos en %s\n", cfg.output);
+
+    return cfg.baseline ? compare_baseline(&cfg, &env, &metrics) : 0;
+}
@@ -0,0 +1,14 @@
+#include "esp_log.h"
+
+/*
+ * Punto de entrada de la build nativa: en el ESP32 app_main() la lanza
+ * la tarea principal de FreeRTOS, aquí la llamamos desde main().
+ */
+
+void app_main(void);
+
+int main(void)
+{
+    app_main();
+    return 0;
+}
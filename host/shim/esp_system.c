@@ -0,0 +1,130 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_chip_info.h"
+#include "esp_mac.h"
+#include "nvs_flash.h"
+#include "soc/rtc.h"
+
+#ifndef CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ
+#define CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ 160
+#endif
+
+#ifndef CONFIG_LOG_DEFAULT_LEVEL
+#define CONFIG_LOG_DEFAULT_LEVEL ESP_LOG_INFO
+#endif
+
+static esp_log_level_t s_log_level = CONFIG_LOG_DEFAULT_LEVEL;
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+    case ESP_OK:                        return "ESP_OK";
+    case ESP_FAIL:                      return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:                return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:           return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE:         return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_NOT_FOUND:             return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_TIMEOUT:               return "ESP_ERR_TIMEOUT";
+    case ESP_ERR_NVS_NO_FREE_PAGES:     return "ESP_ERR_NVS_NO_FREE_PAGES";
+    case ESP_ERR_NVS_NEW_VERSION_FOUND: return "ESP_ERR_NVS_NEW_VERSION_FOUND";
+    case ESP_ERR_HTTPD_HANDLERS_FULL:   return "ESP_ERR_HTTPD_HANDLERS_FULL";
+    case ESP_ERR_HTTPD_HANDLER_EXISTS:  return "ESP_ERR_HTTPD_HANDLER_EXISTS";
+    case ESP_ERR_HTTPD_TASK:            return "ESP_ERR_HTTPD_TASK";
+    default:                            return "UNKNOWN ERROR";
+    }
+}
+
+/* Solo se soporta el nivel global ("*"), que es lo que necesita el benchmark */
+void esp_log_level_set(const char *tag, esp_log_level_t level)
+{
+    if (tag != NULL && strcmp(tag, "*") == 0) {
+        s_log_level = level;
+    }
+}
+
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...)
+{
+    static const char letters[] = "NEWIDV";
+
+    if (level > s_log_level) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "%c (%lld) %s: ", letters[level],
+            (long long)(esp_timer_get_time() / 1000), tag);
+    vfprintf(stderr, format, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+static struct timespec s_boot_time;
+
+__attribute__((constructor))
+static void esp_host_boot(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &s_boot_time);
+}
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)(now.tv_sec - s_boot_time.tv_sec) * 1000000 +
+           (now.tv_nsec - s_boot_time.tv_nsec) / 1000;
+}
+
+void esp_restart(void)
+{
+    ESP_LOGW("esp_host", "esp_restart(): saliendo del emulador");
+    fflush(NULL);
+    exit(EXIT_SUCCESS);
+}
+
+void esp_chip_info(esp_chip_info_t *out_info)
+{
+    memset(out_info, 0, sizeof(*out_info));
+    out_info->model = CHIP_ESP32;
+    out_info->features = CHIP_FEATURE_WIFI_BGN | CHIP_FEATURE_BT | CHIP_FEATURE_BLE;
+    out_info->revision = 301;
+    out_info->cores = 2;
+}
+
+esp_err_t esp_read_mac(uint8_t *mac, esp_mac_type_t type)
+{
+    static const uint8_t base_mac[6] = { 0x24, 0x0a, 0xc4, 0x00, 0x00, 0x00 };
+
+    if (mac == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memcpy(mac, base_mac, sizeof(base_mac));
+    mac[5] += (uint8_t)type;
+    return ESP_OK;
+}
+
+void rtc_clk_cpu_freq_get_config(rtc_cpu_freq_config_t *out_config)
+{
+    out_config->source = SOC_CPU_CLK_SRC_PLL;
+    out_config->source_freq_mhz = 480;
+    out_config->div = 480 / CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ;
+    out_config->freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ;
+}
+
+esp_err_t nvs_flash_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void)
+{
+    return ESP_OK;
+}
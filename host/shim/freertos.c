@@ -0,0 +1,103 @@
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+
+struct EventGroupDef_t {
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    EventBits_t     bits;
+};
+
+void vTaskDelay(const TickType_t xTicksToDelay)
+{
+    uint64_t ms = (uint64_t)xTicksToDelay * 1000 / CONFIG_FREERTOS_HZ;
+    struct timespec ts = {
+        .tv_sec  = (time_t)(ms / 1000),
+        .tv_nsec = (long)(ms % 1000) * 1000000L,
+    };
+
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+    }
+}
+
+EventGroupHandle_t xEventGroupCreate(void)
+{
+    EventGroupHandle_t group = calloc(1, sizeof(*group));
+
+    if (group != NULL) {
+        pthread_mutex_init(&group->lock, NULL);
+        pthread_cond_init(&group->cond, NULL);
+    }
+    return group;
+}
+
+void vEventGroupDelete(EventGroupHandle_t xEventGroup)
+{
+    pthread_cond_destroy(&xEventGroup->cond);
+    pthread_mutex_destroy(&xEventGroup->lock);
+    free(xEventGroup);
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet)
+{
+    pthread_mutex_lock(&xEventGroup->lock);
+    xEventGroup->bits |= uxBitsToSet;
+    EventBits_t bits = xEventGroup->bits;
+    pthread_cond_broadcast(&xEventGroup->cond);
+    pthread_mutex_unlock(&xEventGroup->lock);
+    return bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear)
+{
+    pthread_mutex_lock(&xEventGroup->lock);
+    EventBits_t bits = xEventGroup->bits;
+    xEventGroup->bits &= ~uxBitsToClear;
+    pthread_mutex_unlock(&xEventGroup->lock);
+    return bits;
+}
+
+static int bits_satisfied(EventBits_t bits, EventBits_t wanted, BaseType_t all)
+{
+    return all ? (bits & wanted) == wanted : (bits & wanted) != 0;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t xEventGroup,
+                                const EventBits_t uxBitsToWaitFor,
+                                const BaseType_t xClearOnExit,
+                                const BaseType_t xWaitForAllBits,
+                                TickType_t xTicksToWait)
+{
+    struct timespec deadline;
+
+    if (xTicksToWait != portMAX_DELAY) {
+        uint64_t ms = (uint64_t)xTicksToWait * 1000 / CONFIG_FREERTOS_HZ;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += (time_t)(ms / 1000);
+        deadline.tv_nsec += (long)(ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+
+    pthread_mutex_lock(&xEventGroup->lock);
+    while (!bits_satisfied(xEventGroup->bits, uxBitsToWaitFor, xWaitForAllBits)) {
+        if (xTicksToWait == portMAX_DELAY) {
+            pthread_cond_wait(&xEventGroup->cond, &xEventGroup->lock);
+        } else if (pthread_cond_timedwait(&xEventGroup->cond, &xEventGroup->lock,
+                                          &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+    EventBits_t bits = xEventGroup->bits;
+    if (xClearOnExit && bits_satisfied(bits, uxBitsToWaitFor, xWaitForAllBits)) {
+        xEventGroup->bits &= ~uxBitsToWaitFor;
+    }
+    pthread_mutex_unlock(&xEventGroup->lock);
+    return bits;
+}
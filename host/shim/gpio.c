@@ -0,0 +1,35 @@
+#include <stdint.h>
+#include "driver/gpio.h"
+
+static uint32_t s_levels[GPIO_NUM_MAX];
+static uint64_t s_output_mask;
+
+esp_err_t gpio_config(const gpio_config_t *pGPIOConfig)
+{
+    if (pGPIOConfig == NULL || (pGPIOConfig->pin_bit_mask >> GPIO_NUM_MAX) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (pGPIOConfig->mode & GPIO_MODE_OUTPUT) {
+        s_output_mask |= pGPIOConfig->pin_bit_mask;
+    } else {
+        s_output_mask &= ~pGPIOConfig->pin_bit_mask;
+    }
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+    if (gpio_num < 0 || gpio_num >= GPIO_NUM_MAX || !(s_output_mask & (1ULL << gpio_num))) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_levels[gpio_num] = level ? 1 : 0;
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+    if (gpio_num < 0 || gpio_num >= GPIO_NUM_MAX) {
+        return 0;
+    }
+    return (int)s_levels[gpio_num];
+}
@@ -0,0 +1,131 @@
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "esp_system.h"
+#include "esp_host.h"
+
+/*
+ * Heap emulado: el enlazador redirige malloc/calloc/realloc/free del
+ * firmware y del shim (-Wl,--wrap) hacia estas funciones, que llevan la
+ * cuenta de bytes en uso y del mínimo de memoria libre. Así la consulta
+ * de esp_get_free_heap_size() es una lectura atómica, como en el ESP32,
+ * y no depende de la libc.
+ *
+ * Lo que reserva la propia libc (strdup, asprintf, getline,
+ * posix_memalign...) no lleva cabecera: free() y realloc() lo reconocen
+ * por la falta de HEAP_MAGIC y se lo pasan a la libc sin contarlo.
+ */
+
+#define HEAP_MAGIC  0x4553503248454150ULL   /* "ESP2HEAP" */
+
+/* magic queda justo antes del puntero devuelto, donde glibc guarda el tamaño del chunk */
+typedef union {
+    struct {
+        size_t size;
+        uint64_t magic;
+    };
+    max_align_t align;
+} heap_header_t;
+
+void *__real_malloc(size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+static atomic_size_t s_heap_used;
+static atomic_size_t s_heap_peak;
+
+static void heap_account_alloc(size_t size)
+{
+    size_t used = atomic_fetch_add_explicit(&s_heap_used, size, memory_order_relaxed) + size;
+    size_t peak = atomic_load_explicit(&s_heap_peak, memory_order_relaxed);
+
+    while (used > peak &&
+           !atomic_compare_exchange_weak_explicit(&s_heap_peak, &peak, used,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+void *__wrap_malloc(size_t size)
+{
+    if (size > SIZE_MAX - sizeof(heap_header_t)) {
+        return NULL;
+    }
+    heap_header_t *hdr = __real_malloc(sizeof(*hdr) + size);
+    if (hdr == NULL) {
+        return NULL;
+    }
+    hdr->size = size;
+    hdr->magic = HEAP_MAGIC;
+    heap_account_alloc(size);
+    return hdr + 1;
+}
+
+static heap_header_t *heap_header(void *ptr)
+{
+    heap_header_t *hdr = (heap_header_t *)ptr - 1;
+    return hdr->magic == HEAP_MAGIC ? hdr : NULL;
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+    if (size != 0 && nmemb > SIZE_MAX / size) {
+        return NULL;
+    }
+    void *ptr = __wrap_malloc(nmemb * size);
+    if (ptr != NULL) {
+        memset(ptr, 0, nmemb * size);
+    }
+    return ptr;
+}
+
+void __wrap_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    heap_header_t *hdr = heap_header(ptr);
+    if (hdr == NULL) {
+        __real_free(ptr);
+        return;
+    }
+    hdr->magic = 0;
+    atomic_fetch_sub_explicit(&s_heap_used, hdr->size, memory_order_relaxed);
+    __real_free(hdr);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    if (ptr == NULL) {
+        return __wrap_malloc(size);
+    }
+    heap_header_t *hdr = heap_header(ptr);
+    if (hdr == NULL) {
+        return __real_realloc(ptr, size);
+    }
+    if (size > SIZE_MAX - sizeof(heap_header_t)) {
+        return NULL;
+    }
+
+    size_t old_size = hdr->size;
+    hdr = __real_realloc(hdr, sizeof(*hdr) + size);
+    if (hdr == NULL) {
+        return NULL;
+    }
+    hdr->size = size;
+    atomic_fetch_sub_explicit(&s_heap_used, old_size, memory_order_relaxed);
+    heap_account_alloc(size);
+    return hdr + 1;
+}
+
+uint32_t esp_get_free_heap_size(void)
+{
+    size_t used = atomic_load_explicit(&s_heap_used, memory_order_relaxed);
+    return used >= ESP_HOST_HEAP_SIZE ? 0 : (uint32_t)(ESP_HOST_HEAP_SIZE - used);
+}
+
+uint32_t esp_get_minimum_free_heap_size(void)
+{
+    size_t peak = atomic_load_explicit(&s_heap_peak, memory_order_relaxed);
+    return peak >= ESP_HOST_HEAP_SIZE ? 0 : (uint32_t)(ESP_HOST_HEAP_SIZE - peak);
+}
@@ -0,0 +1,597 @@
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_http_server.h"
+#include "esp_host.h"
+
+/*
+ * Servidor HTTP mínimo sobre sockets POSIX con la misma API que
+ * esp_http_server. Igual que en el ESP32, una única tarea atiende todas
+ * las conexiones (poll en vez de select) y los handlers se ejecutan en
+ * ella, con una pila propia que se "pinta" para medir su uso máximo.
+ */
+
+#define HTTPD_HOST_MIN_STACK   (64 * 1024)
+#define HTTPD_STACK_FILL       0xa5
+#define HTTPD_RESP_HDR_LEN     256
+
+static const char *TAG = "esp_host_httpd";
+
+struct sock_db {
+    int fd;
+    uint64_t lru_counter;
+    size_t len;
+    char buf[CONFIG_HTTPD_MAX_REQ_HDR_LEN + 1];
+};
+
+struct httpd_req_aux {
+    struct sock_db *sd;
+    const char *status;
+    const char *content_type;
+    size_t remaining;
+    size_t body_buffered;
+    bool close_after;
+};
+
+struct httpd_data {
+    httpd_config_t config;
+    int listen_fd;
+    int ctrl_fds[2];
+    uint16_t port;
+    pthread_t thread;
+    uint8_t *stack;
+    size_t stack_size;
+    uintptr_t stack_entry;
+    uint64_t lru_counter;
+    httpd_uri_t *handlers;
+    struct sock_db **socks;
+};
+
+static void sock_close(struct httpd_data *hd, int idx)
+{
+    close(hd->socks[idx]->fd);
+    free(hd->socks[idx]);
+    hd->socks[idx] = NULL;
+}
+
+static int send_all(int fd, struct iovec *iov, int iovcnt)
+{
+    struct msghdr msg = { .msg_iov = iov, .msg_iovlen = iovcnt };
+
+    while (msg.msg_iovlen > 0) {
+        ssize_t sent = sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN ? HTTPD_SOCK_ERR_TIMEOUT : HTTPD_SOCK_ERR_FAIL;
+        }
+        while (msg.msg_iovlen > 0 && (size_t)sent >= msg.msg_iov->iov_len) {
+            sent -= msg.msg_iov->iov_len;
+            msg.msg_iov++;
+            msg.msg_iovlen--;
+        }
+        if (msg.msg_iovlen > 0) {
+            msg.msg_iov->iov_base = (char *)msg.msg_iov->iov_base + sent;
+            msg.msg_iov->iov_len -= sent;
+        }
+    }
+    return 0;
+}
+
+static esp_err_t send_response(int fd, const char *status, const char *type,
+                               const char *body, size_t body_len)
+{
+    char hdr[HTTPD_RESP_HDR_LEN];
+    int hdr_len = snprintf(hdr, sizeof(hdr),
+                           "HTTP/1.1 %s\r\n"
+                           "Content-Type: %s\r\n"
+                           "Content-Length: %zu\r\n"
+                           "\r\n",
+                           status, type, body_len);
+    struct iovec iov[2] = {
+        { .iov_base = hdr, .iov_len = (size_t)hdr_len },
+        { .iov_base = (void *)body, .iov_len = body_len },
+    };
+
+    return send_all(fd, iov, body_len ? 2 : 1) == 0 ? ESP_OK : ESP_FAIL;
+}
+
+static void send_error(int fd, const char *status, const char *msg)
+{
+    send_response(fd, status, HTTPD_TYPE_TEXT, msg, strlen(msg));
+}
+
+static bool uri_matches(const char *template, const char *uri)
+{
+    size_t len = strcspn(uri, "?");
+    return strlen(template) == len && strncmp(template, uri, len) == 0;
+}
+
+/* Busca token (sin distinguir mayúsculas) en la lista separada por comas de un valor de cabecera */
+static bool header_has_token(const char *value, size_t len, const char *token)
+{
+    size_t token_len = strlen(token);
+
+    while (len > 0) {
+        size_t item_len = 0;
+        while (item_len < len && value[item_len] != ',') {
+            item_len++;
+        }
+        const char *item = value;
+        size_t n = item_len;
+        while (n > 0 && (*item == ' ' || *item == '\t')) {
+            item++;
+            n--;
+        }
+        while (n > 0 && (item[n - 1] == ' ' || item[n - 1] == '\t')) {
+            n--;
+        }
+        if (n == token_len && strncasecmp(item, token, token_len) == 0) {
+            return true;
+        }
+        value += item_len;
+        len -= item_len;
+        if (len > 0) {
+            value++;
+            len--;
+        }
+    }
+    return false;
+}
+
+static int parse_method(const char *method)
+{
+    static const struct { const char *name; httpd_method_t method; } methods[] = {
+        { "GET", HTTP_GET }, { "POST", HTTP_POST }, { "PUT", HTTP_PUT },
+        { "DELETE", HTTP_DELETE }, { "HEAD", HTTP_HEAD },
+    };
+
+    for (size_t i = 0; i < sizeof(methods) / sizeof(methods[0]); i++) {
+        if (strcmp(methods[i].name, method) == 0) {
+            return methods[i].method;
+        }
+    }
+    return -1;
+}
+
+/* Procesa una petición completa ya presente en sd->buf. Devuelve false si hay que cerrar el socket */
+static bool handle_request(struct httpd_data *hd, struct sock_db *sd, size_t hdr_len)
+{
+    httpd_req_t req = { .handle = hd };
+    struct httpd_req_aux aux = {
+        .sd = sd,
+        .status = HTTPD_200,
+        .content_type = HTTPD_TYPE_TEXT,
+    };
+    char method[8];
+    char *uri = (char *)req.uri;
+
+    sd->buf[hdr_len - 2] = '\0';
+    size_t method_len = strcspn(sd->buf, " \r");
+    const char *uri_start = sd->buf + method_len + 1;
+    size_t uri_len = sd->buf[method_len] == ' ' ? strcspn(uri_start, " \r") : 0;
+    if (method_len >= sizeof(method) || uri_len == 0 ||
+        strncmp(uri_start + uri_len, " HTTP/1.", 8) != 0) {
+        send_error(sd->fd, HTTPD_400, "Bad request syntax");
+        return false;
+    }
+    if (uri_len > CONFIG_HTTPD_MAX_URI_LEN) {
+        send_error(sd->fd, HTTPD_414, "URI is too long");
+        return false;
+    }
+    memcpy(method, sd->buf, method_len);
+    method[method_len] = '\0';
+    memcpy(uri, uri_start, uri_len);
+    uri[uri_len] = '\0';
+
+    for (char *line = strstr(sd->buf, "\r\n"); line != NULL; line = strstr(line, "\r\n")) {
+        line += 2;
+        if (strncasecmp(line, "Content-Length:", 15) == 0) {
+            req.content_len = strtoul(line + 15, NULL, 10);
+        } else if (strncasecmp(line, "Connection:", 11) == 0) {
+            aux.close_after = header_has_token(line + 11, strcspn(line + 11, "\r"), "close");
+        }
+    }
+
+    req.method = parse_method(method);
+    req.aux = &aux;
+    aux.remaining = req.content_len;
+    aux.body_buffered = sd->len - hdr_len;
+    memmove(sd->buf, sd->buf + hdr_len, aux.body_buffered);
+    sd->len = aux.body_buffered;
+
+    const httpd_uri_t *handler = NULL;
+    bool uri_found = false;
+    for (int i = 0; i < hd->config.max_uri_handlers && hd->handlers[i].uri != NULL; i++) {
+        if (uri_matches(hd->handlers[i].uri, req.uri)) {
+            uri_found = true;
+            if ((int)hd->handlers[i].method == req.method) {
+                handler = &hd->handlers[i];
+                break;
+            }
+        }
+    }
+
+    if (handler == NULL) {
+        if (uri_found) {
+            send_error(sd->fd, "405 Method Not Allowed",
+                       "Request method for this URI is not handled by server");
+        } else {
+            send_error(sd->fd, HTTPD_404, "This URI does not exist");
+        }
+        return false;
+    }
+
+    req.user_ctx = handler->user_ctx;
+    if (handler->handler(&req) != ESP_OK) {
+        ESP_LOGW(TAG, "El handler de %s devolvió error, cerrando socket %d", req.uri, sd->fd);
+        return false;
+    }
+
+    /* Descarta el cuerpo que el handler no haya leído */
+    char scratch[CONFIG_HTTPD_PURGE_BUF_LEN];
+    while (aux.remaining > 0) {
+        if (httpd_req_recv(&req, scratch, sizeof(scratch)) <= 0) {
+            return false;
+        }
+    }
+
+    return !aux.close_after;
+}
+
+static bool sock_process(struct httpd_data *hd, struct sock_db *sd)
+{
+    ssize_t n = recv(sd->fd, sd->buf + sd->len, CONFIG_HTTPD_MAX_REQ_HDR_LEN - sd->len, 0);
+    if (n <= 0) {
+        return false;
+    }
+    sd->len += (size_t)n;
+    sd->lru_counter = ++hd->lru_counter;
+
+    for (;;) {
+        sd->buf[sd->len] = '\0';
+        char *end = strstr(sd->buf, "\r\n\r\n");
+        if (end == NULL) {
+            if (sd->len == CONFIG_HTTPD_MAX_REQ_HDR_LEN) {
+                send_error(sd->fd, "431 Request Header Fields Too Large", "Header fields are too long");
+                return false;
+            }
+            return true;
+        }
+        if (!handle_request(hd, sd, (size_t)(end - sd->buf) + 4)) {
+            return false;
+        }
+    }
+}
+
+static void sock_accept(struct httpd_data *hd)
+{
+    int fd = accept(hd->listen_fd, NULL, NULL);
+    if (fd < 0) {
+        return;
+    }
+
+    int idx = -1;
+    int lru = -1;
+    for (int i = 0; i < hd->config.max_open_sockets; i++) {
+        if (hd->socks[i] == NULL) {
+            idx = i;
+            break;
+        }
+        if (lru < 0 || hd->socks[i]->lru_counter < hd->socks[lru]->lru_counter) {
+            lru = i;
+        }
+    }
+    if (idx < 0) {
+        if (!hd->config.lru_purge_enable) {
+            ESP_LOGW(TAG, "Sin sockets libres, rechazando conexión");
+            close(fd);
+            return;
+        }
+        sock_close(hd, lru);
+        idx = lru;
+    }
+
+    struct timeval tv = { .tv_sec = hd->config.recv_wait_timeout };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    tv.tv_sec = hd->config.send_wait_timeout;
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    hd->socks[idx] = calloc(1, sizeof(struct sock_db));
+    if (hd->socks[idx] == NULL) {
+        close(fd);
+        return;
+    }
+    hd->socks[idx]->fd = fd;
+    hd->socks[idx]->lru_counter = ++hd->lru_counter;
+}
+
+static void *httpd_server_task(void *arg)
+{
+    struct httpd_data *hd = arg;
+    /* Por encima de este marco glibc guarda el descriptor del hilo y la TLS */
+    hd->stack_entry = (uintptr_t)__builtin_frame_address(0);
+    int nfds = hd->config.max_open_sockets + 2;
+    struct pollfd pfds[nfds];
+
+    for (;;) {
+        pfds[0] = (struct pollfd){ .fd = hd->ctrl_fds[0], .events = POLLIN };
+        pfds[1] = (struct pollfd){ .fd = hd->listen_fd, .events = POLLIN };
+        for (int i = 0; i < hd->config.max_open_sockets; i++) {
+            pfds[i + 2] = (struct pollfd){ .fd = hd->socks[i] ? hd->socks[i]->fd : -1, .events = POLLIN };
+        }
+
+        if (poll(pfds, (nfds_t)nfds, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (pfds[0].revents) {
+            break;
+        }
+        for (int i = 0; i < hd->config.max_open_sockets; i++) {
+            if (hd->socks[i] != NULL && pfds[i + 2].revents &&
+                !sock_process(hd, hd->socks[i])) {
+                sock_close(hd, i);
+            }
+        }
+        if (pfds[1].revents & POLLIN) {
+            sock_accept(hd);
+        }
+    }
+
+    for (int i = 0; i < hd->config.max_open_sockets; i++) {
+        if (hd->socks[i] != NULL) {
+            sock_close(hd, i);
+        }
+    }
+    return NULL;
+}
+
+static int create_listen_socket(const httpd_config_t *config, uint16_t *bound_port)
+{
+    uint16_t port = config->server_port;
+    const char *env_port = getenv(ESP_HOST_HTTPD_PORT_ENV);
+    if (env_port != NULL) {
+        port = (uint16_t)strtoul(env_port, NULL, 10);
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(port),
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+    };
+    socklen_t addr_len = sizeof(addr);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        listen(fd, config->backlog_conn) < 0 ||
+        getsockname(fd, (struct sockaddr *)&addr, &addr_len) < 0) {
+        ESP_LOGE(TAG, "No se pudo escuchar en el puerto %u: %s", port, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    *bound_port = ntohs(addr.sin_port);
+    return fd;
+}
+
+static void httpd_free(struct httpd_data *hd)
+{
+    free(hd->handlers);
+    free(hd->socks);
+    if (hd->stack != NULL) {
+        munmap(hd->stack, hd->stack_size);
+    }
+    free(hd);
+}
+
+esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config)
+{
+    if (handle == NULL || config == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct httpd_data *hd = calloc(1, sizeof(*hd));
+    if (hd == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    hd->config = *config;
+    hd->stack_size = config->stack_size > HTTPD_HOST_MIN_STACK ? config->stack_size : HTTPD_HOST_MIN_STACK;
+    hd->handlers = calloc(config->max_uri_handlers, sizeof(httpd_uri_t));
+    hd->socks = calloc(config->max_open_sockets, sizeof(struct sock_db *));
+    /* La pila se reserva fuera del heap: su tamaño en host no es el del ESP32 */
+    hd->stack = mmap(NULL, hd->stack_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (hd->stack == MAP_FAILED) {
+        hd->stack = NULL;
+    }
+    if (hd->handlers == NULL || hd->socks == NULL || hd->stack == NULL) {
+        httpd_free(hd);
+        return ESP_ERR_NO_MEM;
+    }
+    memset(hd->stack, HTTPD_STACK_FILL, hd->stack_size);
+
+    hd->listen_fd = create_listen_socket(config, &hd->port);
+    if (hd->listen_fd < 0) {
+        httpd_free(hd);
+        return ESP_FAIL;
+    }
+    if (pipe(hd->ctrl_fds) < 0) {
+        close(hd->listen_fd);
+        httpd_free(hd);
+        return ESP_FAIL;
+    }
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, hd->stack, hd->stack_size);
+    int rc = pthread_create(&hd->thread, &attr, httpd_server_task, hd);
+    pthread_attr_destroy(&attr);
+    if (rc != 0) {
+        close(hd->ctrl_fds[0]);
+        close(hd->ctrl_fds[1]);
+        close(hd->listen_fd);
+        httpd_free(hd);
+        return ESP_ERR_HTTPD_TASK;
+    }
+
+    ESP_LOGI(TAG, "Escuchando en el puerto %u", hd->port);
+    *handle = hd;
+    return ESP_OK;
+}
+
+esp_err_t httpd_stop(httpd_handle_t handle)
+{
+    struct httpd_data *hd = handle;
+
+    if (hd == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (write(hd->ctrl_fds[1], "x", 1) != 1) {
+        return ESP_FAIL;
+    }
+    pthread_join(hd->thread, NULL);
+    close(hd->ctrl_fds[0]);
+    close(hd->ctrl_fds[1]);
+    close(hd->listen_fd);
+    httpd_free(hd);
+    return ESP_OK;
+}
+
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t *uri_handler)
+{
+    struct httpd_data *hd = handle;
+
+    if (hd == NULL || uri_handler == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (int i = 0; i < hd->config.max_uri_handlers; i++) {
+        if (hd->handlers[i].uri == NULL) {
+            hd->handlers[i] = *uri_handler;
+            return ESP_OK;
+        }
+        if (strcmp(hd->handlers[i].uri, uri_handler->uri) == 0 &&
+            hd->handlers[i].method == uri_handler->method) {
+            return ESP_ERR_HTTPD_HANDLER_EXISTS;
+        }
+    }
+    return ESP_ERR_HTTPD_HANDLERS_FULL;
+}
+
+int httpd_req_recv(httpd_req_t *r, char *buf, size_t buf_len)
+{
+    struct httpd_req_aux *aux = r->aux;
+    struct sock_db *sd = aux->sd;
+
+    if (buf_len > aux->remaining) {
+        buf_len = aux->remaining;
+    }
+    if (buf_len == 0) {
+        return 0;
+    }
+
+    if (aux->body_buffered > 0) {
+        size_t n = buf_len < aux->body_buffered ? buf_len : aux->body_buffered;
+        memcpy(buf, sd->buf, n);
+        memmove(sd->buf, sd->buf + n, sd->len - n);
+        sd->len -= n;
+        aux->body_buffered -= n;
+        aux->remaining -= n;
+        return (int)n;
+    }
+
+    ssize_t n;
+    do {
+        n = recv(sd->fd, buf, buf_len, 0);
+    } while (n < 0 && errno == EINTR);
+    if (n < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? HTTPD_SOCK_ERR_TIMEOUT : HTTPD_SOCK_ERR_FAIL;
+    }
+    if (n == 0) {
+        return HTTPD_SOCK_ERR_FAIL;
+    }
+    aux->remaining -= (size_t)n;
+    return (int)n;
+}
+
+esp_err_t httpd_resp_set_status(httpd_req_t *r, const char *status)
+{
+    if (r == NULL || status == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    ((struct httpd_req_aux *)r->aux)->status = status;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_type(httpd_req_t *r, const char *type)
+{
+    if (r == NULL || type == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    ((struct httpd_req_aux *)r->aux)->content_type = type;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send(httpd_req_t *r, const char *buf, ssize_t buf_len)
+{
+    struct httpd_req_aux *aux = r->aux;
+
+    if (buf == NULL) {
+        buf_len = 0;
+    } else if (buf_len == HTTPD_RESP_USE_STRLEN) {
+        buf_len = (ssize_t)strlen(buf);
+    }
+    return send_response(aux->sd->fd, aux->status, aux->content_type, buf, (size_t)buf_len);
+}
+
+esp_err_t httpd_resp_send_408(httpd_req_t *r)
+{
+    struct httpd_req_aux *aux = r->aux;
+
+    aux->close_after = true;
+    send_error(aux->sd->fd, HTTPD_408, "Server closed this connection");
+    return ESP_OK;
+}
+
+uint16_t esp_host_httpd_port(httpd_handle_t handle)
+{
+    return ((struct httpd_data *)handle)->port;
+}
+
+/*
+ * La pila crece hacia abajo: lo que sigue pintado al principio nunca se ha
+ * tocado. Se mide desde la entrada de httpd_server_task() para no contar
+ * lo que glibc coloca en la parte alta de la pila.
+ */
+size_t esp_host_httpd_stack_peak(httpd_handle_t handle)
+{
+    struct httpd_data *hd = handle;
+    size_t untouched = 0;
+
+    while (untouched < hd->stack_size && hd->stack[untouched] == HTTPD_STACK_FILL) {
+        untouched++;
+    }
+    uintptr_t lowest = (uintptr_t)hd->stack + untouched;
+    return hd->stack_entry > lowest ? hd->stack_entry - lowest : 0;
+}
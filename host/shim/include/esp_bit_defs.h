@@ -0,0 +1,10 @@
+#ifndef ESP_BIT_DEFS_H
+#define ESP_BIT_DEFS_H
+
+#define BIT(nr)  (1UL << (nr))
+#define BIT0     0x00000001
+#define BIT1     0x00000002
+#define BIT2     0x00000004
+#define BIT3     0x00000008
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef ESP_ERR_H
+#define ESP_ERR_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef int esp_err_t;
+
+#define ESP_OK                          0
+#define ESP_FAIL                        -1
+#define ESP_ERR_NO_MEM                  0x101
+#define ESP_ERR_INVALID_ARG             0x102
+#define ESP_ERR_INVALID_STATE           0x103
+#define ESP_ERR_NOT_FOUND               0x105
+#define ESP_ERR_TIMEOUT                 0x107
+#define ESP_ERR_NVS_NO_FREE_PAGES       0x110d
+#define ESP_ERR_NVS_NEW_VERSION_FOUND   0x1110
+#define ESP_ERR_HTTPD_HANDLERS_FULL     0xb001
+#define ESP_ERR_HTTPD_HANDLER_EXISTS    0xb002
+#define ESP_ERR_HTTPD_TASK              0xb008
+
+const char *esp_err_to_name(esp_err_t code);
+
+#define ESP_ERROR_CHECK(x) do {                                         \
+        esp_err_t err_rc_ = (x);                                        \
+        if (err_rc_ != ESP_OK) {                                        \
+            fprintf(stderr, "ESP_ERROR_CHECK fallido: %s (0x%x) en %s:%d\n", \
+                    esp_err_to_name(err_rc_), err_rc_, __FILE__, __LINE__); \
+            abort();                                                    \
+        }                                                               \
+    } while (0)
+
+#endif
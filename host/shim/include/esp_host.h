@@ -0,0 +1,22 @@
+#ifndef ESP_HOST_H
+#define ESP_HOST_H
+
+/*
+ * Extensiones solo disponibles en la build nativa (host/).
+ * El firmware no las usa; sirven al emulador y al benchmark.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_http_server.h"
+
+/* Variable de entorno que sustituye el puerto de HTTPD_DEFAULT_CONFIG (0 = efímero) */
+#define ESP_HOST_HTTPD_PORT_ENV  "ESP_HOST_HTTPD_PORT"
+
+/* Tamaño del heap emulado que reportan esp_get_free_heap_size() y compañía */
+#define ESP_HOST_HEAP_SIZE       (300 * 1024)
+
+uint16_t esp_host_httpd_port(httpd_handle_t handle);
+size_t esp_host_httpd_stack_peak(httpd_handle_t handle);
+
+#endif
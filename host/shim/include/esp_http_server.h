@@ -0,0 +1,110 @@
+#ifndef ESP_HTTP_SERVER_H
+#define ESP_HTTP_SERVER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <sys/types.h>
+#include "esp_err.h"
+
+#ifndef CONFIG_HTTPD_MAX_REQ_HDR_LEN
+#define CONFIG_HTTPD_MAX_REQ_HDR_LEN 1024
+#endif
+
+#ifndef CONFIG_HTTPD_MAX_URI_LEN
+#define CONFIG_HTTPD_MAX_URI_LEN 512
+#endif
+
+#ifndef CONFIG_HTTPD_PURGE_BUF_LEN
+#define CONFIG_HTTPD_PURGE_BUF_LEN 32
+#endif
+
+/* Mismos valores que http_parser, que es lo que usa ESP-IDF */
+typedef enum {
+    HTTP_DELETE = 0,
+    HTTP_GET = 1,
+    HTTP_HEAD = 2,
+    HTTP_POST = 3,
+    HTTP_PUT = 4,
+} httpd_method_t;
+
+typedef void *httpd_handle_t;
+
+typedef struct httpd_config {
+    unsigned    task_priority;
+    size_t      stack_size;
+    uint16_t    server_port;
+    uint16_t    ctrl_port;
+    uint16_t    max_open_sockets;
+    uint16_t    max_uri_handlers;
+    uint16_t    max_resp_headers;
+    uint16_t    backlog_conn;
+    bool        lru_purge_enable;
+    uint16_t    recv_wait_timeout;
+    uint16_t    send_wait_timeout;
+} httpd_config_t;
+
+#define HTTPD_DEFAULT_CONFIG() {                        \
+        .task_priority      = 5,                        \
+        .stack_size         = 4096,                     \
+        .server_port        = 80,                       \
+        .ctrl_port          = 32768,                    \
+        .max_open_sockets   = 7,                        \
+        .max_uri_handlers   = 8,                        \
+        .max_resp_headers   = 8,                        \
+        .backlog_conn       = 5,                        \
+        .lru_purge_enable   = false,                    \
+        .recv_wait_timeout  = 5,                        \
+        .send_wait_timeout  = 5,                        \
+}
+
+typedef struct httpd_req {
+    httpd_handle_t  handle;
+    int             method;
+    const char      uri[CONFIG_HTTPD_MAX_URI_LEN + 1];
+    size_t          content_len;
+    void           *aux;
+    void           *user_ctx;
+} httpd_req_t;
+
+typedef struct httpd_uri {
+    const char     *uri;
+    httpd_method_t  method;
+    esp_err_t     (*handler)(httpd_req_t *r);
+    void           *user_ctx;
+} httpd_uri_t;
+
+#define HTTPD_SOCK_ERR_FAIL      -1
+#define HTTPD_SOCK_ERR_INVALID   -2
+#define HTTPD_SOCK_ERR_TIMEOUT   -3
+
+#define HTTPD_RESP_USE_STRLEN    -1
+
+#define HTTPD_200   "200 OK"
+#define HTTPD_204   "204 No Content"
+#define HTTPD_400   "400 Bad Request"
+#define HTTPD_404   "404 Not Found"
+#define HTTPD_408   "408 Request Timeout"
+#define HTTPD_414   "414 URI Too Long"
+#define HTTPD_500   "500 Internal Server Error"
+
+#define HTTPD_TYPE_JSON   "application/json"
+#define HTTPD_TYPE_TEXT   "text/html"
+
+esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config);
+esp_err_t httpd_stop(httpd_handle_t handle);
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t *uri_handler);
+
+int httpd_req_recv(httpd_req_t *r, char *buf, size_t buf_len);
+
+esp_err_t httpd_resp_set_status(httpd_req_t *r, const char *status);
+esp_err_t httpd_resp_set_type(httpd_req_t *r, const char *type);
+esp_err_t httpd_resp_send(httpd_req_t *r, const char *buf, ssize_t buf_len);
+esp_err_t httpd_resp_send_408(httpd_req_t *r);
+
+static inline esp_err_t httpd_resp_sendstr(httpd_req_t *r, const char *str)
+{
+    return httpd_resp_send(r, str, (str == NULL) ? 0 : HTTPD_RESP_USE_STRLEN);
+}
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef ESP_NETIF_H
+#define ESP_NETIF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_event.h"
+
+typedef struct {
+    uint32_t addr;
+} esp_ip4_addr_t;
+
+typedef struct {
+    esp_ip4_addr_t ip;
+    esp_ip4_addr_t netmask;
+    esp_ip4_addr_t gw;
+} esp_netif_ip_info_t;
+
+typedef struct esp_netif_obj esp_netif_t;
+
+#define esp_ip4_addr_get_byte(ipaddr, idx) (((const uint8_t*)(&(ipaddr)->addr))[idx])
+#define esp_ip4_addr1_16(ipaddr) ((uint16_t)esp_ip4_addr_get_byte(ipaddr, 0))
+#define esp_ip4_addr2_16(ipaddr) ((uint16_t)esp_ip4_addr_get_byte(ipaddr, 1))
+#define esp_ip4_addr3_16(ipaddr) ((uint16_t)esp_ip4_addr_get_byte(ipaddr, 2))
+#define esp_ip4_addr4_16(ipaddr) ((uint16_t)esp_ip4_addr_get_byte(ipaddr, 3))
+
+#define IP2STR(ipaddr) esp_ip4_addr1_16(ipaddr), \
+    esp_ip4_addr2_16(ipaddr), \
+    esp_ip4_addr3_16(ipaddr), \
+    esp_ip4_addr4_16(ipaddr)
+
+#define IPSTR "%d.%d.%d.%d"
+
+ESP_EVENT_DECLARE_BASE(IP_EVENT);
+
+typedef enum {
+    IP_EVENT_STA_GOT_IP,
+    IP_EVENT_STA_LOST_IP,
+} ip_event_t;
+
+typedef struct {
+    esp_netif_t *esp_netif;
+    esp_netif_ip_info_t ip_info;
+    bool ip_changed;
+} ip_event_got_ip_t;
+
+esp_err_t esp_netif_init(void);
+esp_netif_t *esp_netif_create_default_wifi_sta(void);
+esp_netif_t *esp_netif_get_handle_from_ifkey(const char *if_key);
+esp_err_t esp_netif_get_ip_info(esp_netif_t *esp_netif, esp_netif_ip_info_t *ip_info);
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_bit_defs.h"
+
+#ifndef CONFIG_FREERTOS_HZ
+#define CONFIG_FREERTOS_HZ 100
+#endif
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdFALSE             ((BaseType_t)0)
+#define pdTRUE              ((BaseType_t)1)
+#define pdPASS              pdTRUE
+#define pdFAIL              pdFALSE
+#define portMAX_DELAY       ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS  ((TickType_t)1000 / CONFIG_FREERTOS_HZ)
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(((TickType_t)(ms) * (TickType_t)CONFIG_FREERTOS_HZ) / (TickType_t)1000U))
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef FREERTOS_TASK_H
+#define FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+void vTaskDelay(const TickType_t xTicksToDelay);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef SOC_RTC_H
+#define SOC_RTC_H
+
+#include <stdint.h>
+
+typedef enum {
+    SOC_CPU_CLK_SRC_XTAL,
+    SOC_CPU_CLK_SRC_PLL,
+    SOC_CPU_CLK_SRC_RC_FAST,
+} soc_cpu_clk_src_t;
+
+typedef struct {
+    soc_cpu_clk_src_t source;
+    uint32_t source_freq_mhz;
+    uint32_t div;
+    uint32_t freq_mhz;
+} rtc_cpu_freq_config_t;
+
+void rtc_clk_cpu_freq_get_config(rtc_cpu_freq_config_t *out_config);
+
+#endif
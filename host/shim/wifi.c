@@ -0,0 +1,269 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include "esp_err.h"
+#include "esp_event.h"
+#include "esp_log.h"
+#include "esp_netif.h"
+#include "esp_wifi.h"
+
+/*
+ * Wi-Fi y bucle de eventos emulados. esp_wifi_connect() "asocia" siempre
+ * contra loopback salvo que ESP_HOST_WIFI_FAIL esté definida, en cuyo caso
+ * se emite WIFI_EVENT_STA_DISCONNECTED para ejercitar los reintentos.
+ */
+
+#define MAX_EVENT_HANDLERS   8
+#define EVENT_DATA_MAX       64
+#define EVENT_QUEUE_SIZE     32
+#define HOST_RSSI            -55
+
+static const char *TAG = "esp_host_wifi";
+
+ESP_EVENT_DEFINE_BASE(WIFI_EVENT);
+ESP_EVENT_DEFINE_BASE(IP_EVENT);
+
+struct esp_netif_obj {
+    const char *if_key;
+    esp_netif_ip_info_t ip_info;
+};
+
+typedef struct {
+    esp_event_base_t base;
+    int32_t id;
+    esp_event_handler_t handler;
+    void *arg;
+} event_handler_t;
+
+typedef struct {
+    esp_event_base_t base;
+    int32_t id;
+    size_t data_size;
+    uint8_t data[EVENT_DATA_MAX];
+} event_item_t;
+
+static pthread_mutex_t s_event_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_event_cond = PTHREAD_COND_INITIALIZER;
+/* Cola de tamaño fijo, como la de FreeRTOS: los eventos no pasan por el heap */
+static event_item_t s_event_queue[EVENT_QUEUE_SIZE];
+static int s_event_head;
+static int s_event_count;
+static event_handler_t s_handlers[MAX_EVENT_HANDLERS];
+static int s_handler_count;
+static bool s_event_loop_created;
+
+static struct esp_netif_obj s_sta_netif = { .if_key = "WIFI_STA_DEF" };
+static bool s_sta_netif_created;
+static wifi_config_t s_sta_config;
+static bool s_wifi_initialized;
+static bool s_sta_connected;
+
+static void *event_loop_task(void *arg)
+{
+    (void)arg;
+
+    for (;;) {
+        pthread_mutex_lock(&s_event_lock);
+        while (s_event_count == 0) {
+            pthread_cond_wait(&s_event_cond, &s_event_lock);
+        }
+        event_item_t item = s_event_queue[s_event_head];
+        s_event_head = (s_event_head + 1) % EVENT_QUEUE_SIZE;
+        s_event_count--;
+        int count = s_handler_count;
+        event_handler_t handlers[MAX_EVENT_HANDLERS];
+        memcpy(handlers, s_handlers, sizeof(handlers));
+        pthread_mutex_unlock(&s_event_lock);
+
+        for (int i = 0; i < count; i++) {
+            if ((handlers[i].base == ESP_EVENT_ANY_BASE || handlers[i].base == item.base) &&
+                (handlers[i].id == ESP_EVENT_ANY_ID || handlers[i].id == item.id)) {
+                handlers[i].handler(handlers[i].arg, item.base, item.id,
+                                    item.data_size ? item.data : NULL);
+            }
+        }
+    }
+    return NULL;
+}
+
+esp_err_t esp_event_loop_create_default(void)
+{
+    pthread_t thread;
+
+    if (s_event_loop_created) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (pthread_create(&thread, NULL, event_loop_task, NULL) != 0) {
+        return ESP_FAIL;
+    }
+    pthread_detach(thread);
+    s_event_loop_created = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_event_handler_instance_register(esp_event_base_t event_base,
+                                              int32_t event_id,
+                                              esp_event_handler_t event_handler,
+                                              void *event_handler_arg,
+                                              esp_event_handler_instance_t *instance)
+{
+    if (event_handler == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pthread_mutex_lock(&s_event_lock);
+    if (s_handler_count == MAX_EVENT_HANDLERS) {
+        pthread_mutex_unlock(&s_event_lock);
+        return ESP_ERR_NO_MEM;
+    }
+    event_handler_t *h = &s_handlers[s_handler_count++];
+    h->base = event_base;
+    h->id = event_id;
+    h->handler = event_handler;
+    h->arg = event_handler_arg;
+    pthread_mutex_unlock(&s_event_lock);
+
+    if (instance != NULL) {
+        *instance = h;
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_event_post(esp_event_base_t event_base,
+                         int32_t event_id,
+                         const void *event_data,
+                         size_t event_data_size,
+                         TickType_t ticks_to_wait)
+{
+    (void)ticks_to_wait;
+
+    if (!s_event_loop_created) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (event_data_size > EVENT_DATA_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pthread_mutex_lock(&s_event_lock);
+    if (s_event_count == EVENT_QUEUE_SIZE) {
+        pthread_mutex_unlock(&s_event_lock);
+        return ESP_ERR_TIMEOUT;
+    }
+    event_item_t *item = &s_event_queue[(s_event_head + s_event_count) % EVENT_QUEUE_SIZE];
+    item->base = event_base;
+    item->id = event_id;
+    item->data_size = event_data_size;
+    if (event_data_size) {
+        memcpy(item->data, event_data, event_data_size);
+    }
+    s_event_count++;
+    pthread_cond_signal(&s_event_cond);
+    pthread_mutex_unlock(&s_event_lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_netif_init(void)
+{
+    return ESP_OK;
+}
+
+esp_netif_t *esp_netif_create_default_wifi_sta(void)
+{
+    s_sta_netif_created = true;
+    return &s_sta_netif;
+}
+
+esp_netif_t *esp_netif_get_handle_from_ifkey(const char *if_key)
+{
+    if (s_sta_netif_created && if_key != NULL && strcmp(if_key, s_sta_netif.if_key) == 0) {
+        return &s_sta_netif;
+    }
+    return NULL;
+}
+
+esp_err_t esp_netif_get_ip_info(esp_netif_t *esp_netif, esp_netif_ip_info_t *ip_info)
+{
+    if (esp_netif == NULL || ip_info == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *ip_info = esp_netif->ip_info;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_init(const wifi_init_config_t *config)
+{
+    if (config == NULL || config->magic != WIFI_INIT_CONFIG_MAGIC) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_wifi_initialized = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_mode(wifi_mode_t mode)
+{
+    if (!s_wifi_initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return mode == WIFI_MODE_STA ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t esp_wifi_set_config(wifi_interface_t interface, wifi_config_t *conf)
+{
+    if (!s_wifi_initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (interface != WIFI_IF_STA || conf == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_sta_config = *conf;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_start(void)
+{
+    if (!s_wifi_initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_START, NULL, 0, portMAX_DELAY);
+}
+
+esp_err_t esp_wifi_connect(void)
+{
+    if (!s_wifi_initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (getenv("ESP_HOST_WIFI_FAIL") != NULL) {
+        s_sta_connected = false;
+        return esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_DISCONNECTED, NULL, 0, portMAX_DELAY);
+    }
+
+    s_sta_netif.ip_info.ip.addr = htonl(INADDR_LOOPBACK);
+    s_sta_netif.ip_info.gw.addr = htonl(INADDR_LOOPBACK);
+    s_sta_netif.ip_info.netmask.addr = htonl(0xff000000);
+    s_sta_connected = true;
+    ESP_LOGI(TAG, "Asociado (emulado) a SSID:%s", (const char *)s_sta_config.sta.ssid);
+
+    ip_event_got_ip_t event = {
+        .esp_netif = &s_sta_netif,
+        .ip_info = s_sta_netif.ip_info,
+        .ip_changed = true,
+    };
+    return esp_event_post(IP_EVENT, IP_EVENT_STA_GOT_IP, &event, sizeof(event), portMAX_DELAY);
+}
+
+esp_err_t esp_wifi_sta_get_ap_info(wifi_ap_record_t *ap_info)
+{
+    if (ap_info == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(ap_info, 0, sizeof(*ap_info));
+    if (!s_sta_connected) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    memcpy(ap_info->ssid, s_sta_config.sta.ssid, sizeof(s_sta_config.sta.ssid));
+    ap_info->rssi = HOST_RSSI;
+    ap_info->authmode = s_sta_config.sta.threshold.authmode;
+    return ESP_OK;
+}
@@ -188,7 +188,7 @@ void get_system_info_json(char* buffer, size_t buffer_size)
         "}",
         chip_info.cores,
         chip_info.revision,
-        cpu_freq_mhz,
+        (unsigned long)cpu_freq_mhz,
         temperature,
         (char*)ap_info.ssid,
         ap_info.rssi,